@@ -0,0 +1,117 @@
+#include "mat.h"
+#include "camera.h"
+#include "hittable.h"
+#include "hittable_list.h"
+#include "sphere.h"
+
+#include <chrono>
+#include <vector>
+
+using namespace std;
+
+//Equal-time noise comparison: bounce-only path tracing vs next-event estimation (light sampling + MIS)
+//Scene lit only by a small light sphere. Noise = RMS per-pixel standard deviation across several
+//independent equal-time renders, so no reference image (and its own noise) enters the score.
+//Bias is checked separately by comparing the mean brightness of a high sample count render of each method.
+
+static double noise(const vector<vector<Color>>& images) {
+    //Per pixel variance across the independent renders (unbiased, n-1), averaged -> RMS error of one render
+    //Measured in the displayed [0, 1] range, so the directly visible light doesn't dominate
+    static const Interval intensity(0.0, 1.0);
+    size_t runs = images.size();
+    double sum = 0;
+    for(size_t i=0;i<images[0].size();i++)
+        for(int c=0;c<3;c++) {
+            double avg = 0;
+            for(const auto& image : images)
+                avg += intensity.clamp(image[i][c]);
+            avg /= runs;
+
+            double variance = 0;
+            for(const auto& image : images) {
+                auto d = intensity.clamp(image[i][c]) - avg;
+                variance += d * d;
+            }
+            sum += variance / (runs - 1);
+        }
+    return sqrt(sum / (3.0 * images[0].size()));
+}
+
+static double mean(const vector<Color>& image) {
+    //Not clamped: clamping pixels with rare bright samples would lower the noisier method's mean
+    double sum = 0;
+    for(const auto& pixel : image)
+        sum += pixel.x() + pixel.y() + pixel.z();
+    return sum / (3.0 * image.size());
+}
+
+static double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    double time_budget = (argc > 1) ? atof(argv[1]) : 2.0; //seconds per render
+    int reference_samples = (argc > 2) ? atoi(argv[2]) : 2000; //spp of the bias check renders
+    int runs = (argc > 3) ? atoi(argv[3]) : 4; //independent renders per method
+    if(runs < 2) runs = 2;
+
+    HittableList world;
+    HittableList lights;
+
+    world.add(make_shared<Sphere>(Point3(0, -1000, 0), 1000, make_shared<Lambertian>(Color(0.5, 0.5, 0.5))));
+    world.add(make_shared<Sphere>(Point3(0, 1, 0), 1.0, make_shared<Lambertian>(Color(0.4, 0.2, 0.1))));
+    world.add(make_shared<Sphere>(Point3(-2.2, 0.7, 0.5), 0.7, make_shared<Lambertian>(Color(0.1, 0.2, 0.5))));
+    world.add(make_shared<Sphere>(Point3(2.2, 0.7, -0.5), 0.7, make_shared<Metal>(Color(0.7, 0.6, 0.5), 0.1)));
+
+    auto light = make_shared<Sphere>(Point3(1, 4, 2), 0.25, make_shared<DiffuseLight>(Color(120, 120, 120)));
+    world.add(light);
+    lights.add(light);
+
+    Camera cam;
+    cam.aspect_ratio = 16.0 / 9.0;
+    cam.image_width = 160;
+    cam.max_depth = 10;
+
+    cam.vfov = 30;
+    cam.lookfrom = Point3(0, 3, 12);
+    cam.lookat = Point3(0, 1, 0);
+    cam.vup = Vec3(0, 1, 0);
+
+    cam.sky_background = false;
+    cam.background = Color(0, 0, 0);
+
+    clog << "Rendering bias check (" << reference_samples << " spp per method)\n";
+    cam.samples_per_pixel = reference_samples;
+    cam.light_sampling = false;
+    auto reference_bounce = cam.render_image(world, lights);
+    cam.light_sampling = true;
+    auto reference_nee = cam.render_image(world, lights);
+
+    //A gap between the two means (beyond noise) points to a bias in one of the integrators
+    cout << "bias check   mean bounce-only=" << mean(reference_bounce) << "  nee+mis=" << mean(reference_nee) << "\n";
+
+    for(bool nee : {false, true}) {
+        cam.light_sampling = nee;
+
+        //Calibrate the cost of one sample per pixel, then spend the time budget
+        cam.samples_per_pixel = 32;
+        auto start = chrono::steady_clock::now();
+        cam.render_image(world, lights);
+        double per_sample = seconds_since(start) / cam.samples_per_pixel;
+
+        cam.samples_per_pixel = int(time_budget / per_sample);
+        if(cam.samples_per_pixel < 1) cam.samples_per_pixel = 1;
+
+        vector<vector<Color>> images;
+        start = chrono::steady_clock::now();
+        for(int run=0;run<runs;run++) //rand() keeps advancing -> independent renders
+            images.push_back(cam.render_image(world, lights));
+        double elapsed = seconds_since(start) / runs;
+
+        //Noise falls as 1/sqrt(time): rescale to exactly the time budget to remove calibration error
+        double image_noise = noise(images);
+        cout << (nee ? "nee+mis    " : "bounce-only") << "  spp=" << cam.samples_per_pixel
+             << "  time=" << elapsed << "s  noise=" << image_noise
+             << "  noise at " << time_budget << "s=" << image_noise * sqrt(elapsed / time_budget) << "\n";
+    }
+}
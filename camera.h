@@ -3,8 +3,11 @@
 
 #include "mat.h"
 #include "hittable.h"
+#include "hittable_list.h"
 #include "material.h"
 
+#include <vector>
+
 using namespace std;
 
 class Camera {
@@ -23,10 +26,30 @@ public:
     double defocus_angle = 0; //Variation angle of rays through each pixel
     double focus_dist = 10; //Distance from lookfrom to plane of perfect focus
 
-    void render(const Hittable& world) { //Creates output for image file
-        initialize();
+    Color background = Color(0, 0, 0); //Scene background color (used when sky_background is off)
+    bool sky_background = true; //Use the blue-white sky gradient instead of the background color
+    bool light_sampling = true; //Next-event estimation: sample the lights directly at diffuse hits (needs samplable lights)
+
+    void render(const Hittable& world) { //Creates output for image file (no explicit lights)
+        render(world, HittableList());
+    }
+
+    void render(const Hittable& world, const Hittable& lights) { //Creates output for image file
+        auto image = render_image(world, lights);
 
         cout << "P3\n" << image_width << ' ' << image_height << "\n255\n";
+        for(const auto& pixel_color : image)
+            write_color(cout, pixel_color);
+    }
+
+    vector<Color> render_image(const Hittable& world, const Hittable& lights) { //Averaged (linear) pixel colors, row by row
+        //lights = emissive objects to sample directly; every emissive object should be added to it
+        //Objects that can't be sampled (can_sample() == false) are ignored; with none left the plain bounce integrator is used
+        initialize();
+        direct_lighting = light_sampling && lights.can_sample();
+
+        vector<Color> image;
+        image.reserve(image_width * image_height);
 
         for(int j=0;j<image_height;j++) {
             clog << "\rScanlines remaining: " << (image_height - j) << ' ' << flush;
@@ -35,12 +58,14 @@ public:
 
                 for(int sample=0;sample<samples_per_pixel;sample++) { //for every random ray for a pixel
                     Ray r = get_ray(i, j);  //Create ray from origin to rand point 
-                    pixel_color += ray_color(r, max_depth, world); //add color from rand point to pixel color
+                    pixel_color += ray_color(r, max_depth, world, lights, 0); //add color from rand point to pixel color
                 }
-                write_color(cout, pixel_samples_scale * pixel_color); //divide global pixel color to num of rays (avg color)
+                image.push_back(pixel_samples_scale * pixel_color); //divide global pixel color to num of rays (avg color)
             }
         }
         clog << "\rDone.            \n";
+
+        return image;
     }
 
 private:
@@ -56,6 +81,8 @@ private:
     Vec3 defocus_disk_u; //Defocus disk horizontal radius
     Vec3 defocus_disk_v; //Defocus disk vertical radius
 
+    bool direct_lighting; //light_sampling is on and there is a light to sample (set per render)
+
     void initialize() {
         image_height = int(image_width / aspect_ratio);
         image_height = (image_height < 1) ? 1 : image_height; //height cannot be less than 1 pixel
@@ -121,21 +148,67 @@ private:
         return center + (p[0] * defocus_disk_u) + (p[1] * defocus_disk_v);
     }
 
-    Color ray_color(const Ray& r, int depth, const Hittable& world) const {   ///Calculate color of ray
+    Color ray_color(const Ray& r, int depth, const Hittable& world, const Hittable& lights, double bsdf_pdf) const {   ///Calculate color of ray
+        //bsdf_pdf = density with which the previous hit scattered r (0 -> camera ray, specular bounce or no light sampling)
         if(depth <= 0) return Color(0, 0, 0); //If ray has no more bounces, return black(null)
         
         HitRecord rec;
 
-        if(world.hit(r, Interval(0.001, infinity), rec)) { //verify if the ray hit an object in 'world'
-           
-            Ray scattered;
-            Color attenuation;
-            if(rec.mat->scatter(r, rec, attenuation, scattered)) {  //create reflected ray
-                return attenuation * ray_color(scattered, depth-1, world); //return color of hit object
-            }
-            return Color(0, 0, 0);
+        if(!world.hit(r, Interval(0.001, infinity), rec)) //verify if the ray hit an object in 'world'
+            return background_color(r);
+
+        Color emission = rec.mat->emitted(r, rec);
+        if(bsdf_pdf > 0 && !emission.near_zero()) {
+            //This light could also have been reached by light sampling at the previous hit -> weight both (MIS)
+            auto light_pdf = lights.pdf_value(r.origin(), r.direction());
+            emission = power_heuristic(bsdf_pdf, light_pdf) * emission;
         }
 
+        Ray scattered;
+        Color attenuation;
+        if(!rec.mat->scatter(r, rec, attenuation, scattered))  //create reflected ray
+            return emission; //light sources don't scatter
+
+        //No light sampling, or last bounce (the scattered ray can't collect its half of the MIS weighted light)
+        //-> only follow the scattered ray, so both modes estimate the same depth-limited image
+        if(!direct_lighting || depth <= 1)
+            return emission + attenuation * ray_color(scattered, depth-1, world, lights, 0);
+
+        auto scatter_pdf = rec.mat->scattering_pdf(r, rec, scattered);
+        if(scatter_pdf <= 0) //specular material -> lights can't be sampled for it
+            return emission + attenuation * ray_color(scattered, depth-1, world, lights, 0);
+
+        Color direct = sample_lights(r, rec, attenuation, world, lights);
+        return emission + direct + attenuation * ray_color(scattered, depth-1, world, lights, scatter_pdf); //return color of hit object
+    }
+
+    Color sample_lights(const Ray& r_in, const HitRecord& rec, const Color& attenuation, const Hittable& world, const Hittable& lights) const {
+        //Direct light: send one ray towards a random point of the lights, weighted against the material sampling (MIS)
+        Ray to_light(rec.p, lights.random(rec.p));
+
+        auto light_pdf = lights.pdf_value(rec.p, to_light.direction());
+        if(light_pdf <= 0) return Color(0, 0, 0); //no lights, or the point is inside one
+
+        auto scatter_pdf = rec.mat->scattering_pdf(r_in, rec, to_light);
+        if(scatter_pdf <= 0) return Color(0, 0, 0); //light is behind the surface
+
+        HitRecord light_rec;
+        if(!world.hit(to_light, Interval(0.001, infinity), light_rec)) return Color(0, 0, 0);
+
+        Color emission = light_rec.mat->emitted(to_light, light_rec); //black if another object blocks the light
+        //attenuation * scatter_pdf = brdf * cos(theta)
+        return (power_heuristic(light_pdf, scatter_pdf) * scatter_pdf / light_pdf) * attenuation * emission;
+    }
+
+    static double power_heuristic(double pdf, double other_pdf) { //MIS weight of a sample taken with 'pdf'
+        auto a = pdf * pdf;
+        auto b = other_pdf * other_pdf;
+        return a / (a + b);
+    }
+
+    Color background_color(const Ray& r) const {
+        if(!sky_background) return background;
+
         Vec3 unit_direction = unit_vector(r.direction());
         auto a = 0.5*(unit_direction.y() + 1.0);
         return (1.0-a)*Color(1.0, 1.0, 1.0) + a*Color(0.5, 0.7, 1.0); //returrn color of bg
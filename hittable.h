@@ -26,6 +26,21 @@ public:
     virtual ~Hittable() = default;
 
     virtual bool hit(const Ray& r, Interval ray_t, HitRecord& rec) const = 0;
+
+    //Light sampling (used for objects passed to the camera as lights)
+    //pdf_value() and random() are only meaningful when can_sample() is true
+    virtual bool can_sample() const { //object supports direct sampling (Sphere, or a list containing one)
+        return false;
+    }
+
+    virtual double pdf_value(const Point3& /*origin*/, const Vec3& /*direction*/) const { //density of random(origin) choosing 'direction'
+        return 0.0;
+    }
+
+    virtual Vec3 random(const Point3& /*origin*/) const { //random direction from origin towards the object
+        //If origin is inside the object the result isn't a sample: its pdf_value() is 0
+        return Vec3(0, 0, 0); //no direction: object can't be sampled
+    }
 };
 
 #endif
\ No newline at end of file
@@ -18,10 +18,13 @@ public:
 
     void add(shared_ptr<Hittable> obj) { 
         objects.push_back(obj); 
+        if(obj->can_sample()) //checked once here: add an object after filling it (e.g. a nested list)
+            sampled.push_back(obj);
     }
 
     void clear() { 
         objects.clear(); 
+        sampled.clear();
     }
 
     bool hit(const Ray& r, Interval ray_t, HitRecord& rec) const override {
@@ -39,6 +42,30 @@ public:
 
         return hit_anything;
     }
+
+    bool can_sample() const override {
+        return !sampled.empty();
+    }
+
+    double pdf_value(const Point3& origin, const Vec3& direction) const override {
+        //Mixture over the objects that can be sampled, each picked with the same probability
+        if(sampled.empty()) return 0.0;
+
+        auto sum = 0.0;
+        for(const auto& object : sampled)
+            sum += object->pdf_value(origin, direction);
+        return sum / sampled.size();
+    }
+
+    Vec3 random(const Point3& origin) const override {
+        if(sampled.empty()) return Vec3(0, 0, 0);
+
+        auto index = int(random_double() * sampled.size());
+        return sampled[index]->random(origin);
+    }
+
+private:
+    std::vector<shared_ptr<Hittable>> sampled; //objects with can_sample() == true, used by light sampling
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,117 @@
+#ifndef MATERIAL_H
+#define MATERIAL_H
+
+#include "mat.h"
+#include "hittable.h"
+
+class Material {
+public:
+    virtual ~Material() = default;
+
+    virtual Color emitted(const Ray& /*r_in*/, const HitRecord& /*rec*/) const { //Light given off by the surface (none by default)
+        return Color(0, 0, 0);
+    }
+
+    virtual bool scatter(const Ray& /*r_in*/, const HitRecord& /*rec*/, Color& /*attenuation*/, Ray& /*scattered*/) const {
+        return false;
+    }
+
+    virtual double scattering_pdf(const Ray& /*r_in*/, const HitRecord& /*rec*/, const Ray& /*scattered*/) const {
+        //Density of scatter() picking the 'scattered' direction (per solid angle)
+        //0 = specular/delta material -> the camera does not sample lights explicitly for it
+        return 0;
+    }
+};
+
+class Lambertian : public Material {
+public:
+    Lambertian(const Color& albedo) : albedo(albedo) {}
+
+    bool scatter(const Ray& /*r_in*/, const HitRecord& rec, Color& attenuation, Ray& scattered) const override {
+        auto scatter_direction = rec.normal + random_unit_vector(); //cosine weighted direction
+
+        if(scatter_direction.near_zero()) //random vector opposite to the normal -> degenerate direction
+            scatter_direction = rec.normal;
+
+        scattered = Ray(rec.p, scatter_direction);
+        attenuation = albedo;
+        return true;
+    }
+
+    double scattering_pdf(const Ray& /*r_in*/, const HitRecord& rec, const Ray& scattered) const override {
+        auto cos_theta = dot(rec.normal, unit_vector(scattered.direction()));
+        return cos_theta < 0 ? 0 : cos_theta / pi; //pdf = cos(theta)/pi
+    }
+
+private:
+    Color albedo;
+};
+
+class Metal : public Material {
+public:
+    Metal(const Color& albedo, double fuzz) : albedo(albedo), fuzz(fuzz < 1 ? fuzz : 1) {}
+
+    bool scatter(const Ray& r_in, const HitRecord& rec, Color& attenuation, Ray& scattered) const override {
+        Vec3 reflected = reflect(r_in.direction(), rec.normal);
+        reflected = unit_vector(reflected) + (fuzz * random_unit_vector()); //randomize end point of reflected ray
+
+        scattered = Ray(rec.p, reflected);
+        attenuation = albedo;
+        return dot(scattered.direction(), rec.normal) > 0; //absorb rays scattered below the surface
+    }
+
+private:
+    Color albedo;
+    double fuzz;
+};
+
+class Dielectric : public Material {
+public:
+    Dielectric(double refraction_index) : refraction_index(refraction_index) {}
+
+    bool scatter(const Ray& r_in, const HitRecord& rec, Color& attenuation, Ray& scattered) const override {
+        attenuation = Color(1.0, 1.0, 1.0);
+        double ri = rec.front_face ? (1.0 / refraction_index) : refraction_index;
+
+        Vec3 unit_direction = unit_vector(r_in.direction());
+        double cos_theta = fmin(dot(-unit_direction, rec.normal), 1.0);
+        double sin_theta = sqrt(1.0 - cos_theta*cos_theta);
+
+        bool cannot_refract = ri * sin_theta > 1.0; //total internal reflection
+        Vec3 direction;
+
+        if(cannot_refract || reflectance(cos_theta, ri) > random_double())
+            direction = reflect(unit_direction, rec.normal);
+        else
+            direction = refract(unit_direction, rec.normal, ri);
+
+        scattered = Ray(rec.p, direction);
+        return true;
+    }
+
+private:
+    double refraction_index; //Refractive index in vacuum or air, or the ratio of the material's refractive index over the enclosing media
+
+    static double reflectance(double cosine, double refraction_index) {
+        //Schlick's approximation for reflectance
+        auto r0 = (1 - refraction_index) / (1 + refraction_index);
+        r0 = r0*r0;
+        return r0 + (1-r0)*pow((1 - cosine), 5);
+    }
+};
+
+class DiffuseLight : public Material {
+public:
+    DiffuseLight(const Color& emit) : emit(emit) {}
+
+    Color emitted(const Ray& /*r_in*/, const HitRecord& rec) const override {
+        if(!rec.front_face) //emit only from the outer side of the surface
+            return Color(0, 0, 0);
+        return emit;
+    }
+
+private:
+    Color emit;
+};
+
+#endif
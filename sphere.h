@@ -38,6 +38,48 @@ public:
         return true;
     }
 
+    bool can_sample() const override {
+        return true;
+    }
+
+    double pdf_value(const Point3& origin, const Vec3& direction) const override {
+        //Uniform density over the cone of directions from origin that see the sphere
+        auto distance_squared = (center - origin).length_squared();
+        if(distance_squared <= radius * radius) //origin inside or on the sphere -> no cone
+            return 0;
+
+        HitRecord rec;
+        if(!this->hit(Ray(origin, direction), Interval(0.001, infinity), rec))
+            return 0;
+
+        auto cos_theta_max = sqrt(1 - radius * radius / distance_squared);
+        auto solid_angle = 2 * pi * (1 - cos_theta_max);
+        return 1 / solid_angle;
+    }
+
+    Vec3 random(const Point3& origin) const override {
+        //Random unit direction inside the cone from origin to the sphere
+        Vec3 direction = center - origin;
+        auto distance_squared = direction.length_squared();
+        if(distance_squared <= radius * radius) //origin inside or on the sphere -> not a sample: direction to the center, pdf_value() is 0
+            return unit_vector(direction);
+
+        //Orthonormal basis around the cone axis (w)
+        Vec3 w = unit_vector(direction);
+        Vec3 a = (fabs(w.x()) > 0.9) ? Vec3(0, 1, 0) : Vec3(1, 0, 0);
+        Vec3 v = unit_vector(cross(w, a));
+        Vec3 u = cross(w, v);
+
+        auto r1 = random_double();
+        auto r2 = random_double();
+        auto cos_theta_max = sqrt(1 - radius * radius / distance_squared);
+        auto z = 1 + r2 * (cos_theta_max - 1); //cos(theta) uniform in [cos_theta_max, 1]
+        auto phi = 2 * pi * r1;
+        auto sin_theta = sqrt(1 - z * z);
+
+        return (cos(phi) * sin_theta) * u + (sin(phi) * sin_theta) * v + z * w;
+    }
+
 private:
     Point3 center;
     double radius;